@@ -0,0 +1,254 @@
+/*
+ * bmp_blit.h - clipped blits of 1bpp2c bitmaps into a framebuffer.
+ *
+ * Header-only. Source is bmp_data[] as emitted by 1bpp2c: rows of
+ * (BMP_WIDTH + 7) / 8 bytes, MSB first by default or LSB first with --lsb.
+ *
+ * Two framebuffer layouts are supported:
+ *   BMP_LAYOUT_ROW   one bit per pixel along each row, stride bytes per row,
+ *                    MSB or LSB first (most TFT/LCD and memory LCDs).
+ *   BMP_LAYOUT_PAGE  one byte per column per page of 8 rows, bit 0 at the
+ *                    top, stride bytes per page (SSD1306, SH1106, ST7565).
+ *
+ * Define BMP_BLIT_WORD to combine the middle of each row 32 bits at a
+ * time in row layout; test/bmp_blit_bench.c compares both paths.
+ */
+#ifndef BMP_BLIT_H
+#define BMP_BLIT_H
+
+#include <stdint.h>
+
+/* Runtime header version, major * 10000 + minor * 100 + patch. */
+#define BMP_RUNTIME_VERSION 10200
+
+#ifndef BMP_INLINE
+#define BMP_INLINE static inline
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    BMP_OP_COPY, /* dst = src */
+    BMP_OP_OR,   /* dst |= src */
+    BMP_OP_AND,  /* dst &= src */
+    BMP_OP_XOR   /* dst ^= src */
+};
+
+enum {
+    BMP_LAYOUT_ROW,
+    BMP_LAYOUT_PAGE
+};
+
+typedef struct {
+    uint8_t *buf;
+    int width;
+    int height;
+    int stride;     /* bytes per row (row layout) or per page (page layout) */
+    uint8_t layout; /* BMP_LAYOUT_ROW or BMP_LAYOUT_PAGE */
+    uint8_t lsb;    /* row layout only: nonzero if buf is LSB first */
+} bmp_surface;
+
+BMP_INLINE uint8_t bmp__rev8(uint8_t b)
+{
+    b = (uint8_t)((b & 0xF0) >> 4 | (b & 0x0F) << 4);
+    b = (uint8_t)((b & 0xCC) >> 2 | (b & 0x33) << 2);
+    b = (uint8_t)((b & 0xAA) >> 1 | (b & 0x55) << 1);
+    return b;
+}
+
+/*
+ * Raster ops reduced to masks so the inner loops do not branch on op:
+ *   dst = (dst & (~mask | ((src & ps) ^ pc))) ^ (src & mask & bm)
+ */
+typedef struct {
+    uint32_t ps, pc, bm;
+} bmp__rop;
+
+BMP_INLINE bmp__rop bmp__rop_for(int op)
+{
+    bmp__rop r = { 0, 0, 0xFFFFFFFFu };
+
+    switch (op) {
+    case BMP_OP_OR:  r.ps = r.pc = 0xFFFFFFFFu; break;
+    case BMP_OP_AND: r.ps = 0xFFFFFFFFu; r.bm = 0; break;
+    case BMP_OP_XOR: r.pc = 0xFFFFFFFFu; break;
+    default: break;
+    }
+    return r;
+}
+
+BMP_INLINE void bmp__rop8(uint8_t *d, uint8_t bits, uint8_t mask, const bmp__rop *r)
+{
+    *d = (uint8_t)((*d & (~mask | ((bits & r->ps) ^ r->pc))) ^ (bits & mask & r->bm));
+}
+
+BMP_INLINE void bmp__apply(uint8_t *d, uint8_t bits, uint8_t mask, int op)
+{
+    bmp__rop r = bmp__rop_for(op);
+    bmp__rop8(d, bits, mask, &r);
+}
+
+/* Source byte k of a row in MSB-first order; bytes outside the row read as 0. */
+BMP_INLINE uint8_t bmp__fetch(const uint8_t *row, int k, int stride, int lsb)
+{
+    if (k < 0 || k >= stride)
+        return 0;
+    return lsb ? bmp__rev8(row[k]) : row[k];
+}
+
+#ifdef BMP_BLIT_WORD
+/* Bit-reverse each of the four bytes of w. */
+BMP_INLINE uint32_t bmp__rev8x4(uint32_t w)
+{
+    w = (w & 0xF0F0F0F0u) >> 4 | (w & 0x0F0F0F0Fu) << 4;
+    w = (w & 0xCCCCCCCCu) >> 2 | (w & 0x33333333u) << 2;
+    w = (w & 0xAAAAAAAAu) >> 1 | (w & 0x55555555u) << 1;
+    return w;
+}
+
+BMP_INLINE uint32_t bmp__load_be32(const uint8_t *p)
+{
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+BMP_INLINE void bmp__store_be32(uint8_t *p, uint32_t w)
+{
+    p[0] = (uint8_t)(w >> 24);
+    p[1] = (uint8_t)(w >> 16);
+    p[2] = (uint8_t)(w >> 8);
+    p[3] = (uint8_t)w;
+}
+#endif
+
+/*
+ * Row layout. Source bits are realigned to destination bytes through a
+ * 16-bit window that slides one source byte per destination byte, so each
+ * source byte is read once and the shift amount is fixed for the whole row.
+ * With BMP_BLIT_WORD, runs of four full destination bytes whose source
+ * bytes lie inside the row are done as one 32-bit shift-merge instead.
+ */
+BMP_INLINE void bmp__blit_row(const bmp_surface *dst, int x, int y,
+                              const uint8_t *src, int src_stride, int src_lsb,
+                              int sx0, int sy0, int cw, int ch, int op)
+{
+    bmp__rop rop = bmp__rop_for(op);
+    int dx0 = x + sx0;
+    int dx1 = dx0 + cw;
+    int db0 = dx0 >> 3;
+    int db1 = (dx1 - 1) >> 3;
+    int s0 = db0 * 8 - x; /* source pixel under the first dest bit, >= -7 */
+    int si0 = (s0 + 8) / 8 - 1;
+    int sh = (s0 + 8) % 8;
+    uint8_t head = (uint8_t)(0xFF >> (dx0 & 7));
+    uint8_t tail = (uint8_t)(0xFF << (7 - ((dx1 - 1) & 7)));
+    int r;
+
+    if (dst->lsb) {
+        head = bmp__rev8(head);
+        tail = bmp__rev8(tail);
+    }
+
+    for (r = 0; r < ch; r++) {
+        const uint8_t *srow = src + (sy0 + r) * src_stride;
+        uint8_t *drow = dst->buf + (y + sy0 + r) * dst->stride;
+        uint16_t acc = bmp__fetch(srow, si0, src_stride, src_lsb);
+        int si = si0;
+        int db;
+
+        for (db = db0; db <= db1; db++) {
+            uint8_t bits, mask = 0xFF;
+
+#ifdef BMP_BLIT_WORD
+            if (db > db0 && db + 3 < db1 && si >= 0 && si + (sh ? 4 : 3) < src_stride) {
+                uint32_t w = bmp__load_be32(srow + si);
+                uint32_t d = bmp__load_be32(drow + db);
+
+                if (src_lsb)
+                    w = bmp__rev8x4(w);
+                if (sh)
+                    w = w << sh | (uint32_t)bmp__fetch(srow, si + 4, src_stride, src_lsb) >> (8 - sh);
+                if (dst->lsb)
+                    w = bmp__rev8x4(w);
+                bmp__store_be32(drow + db, (d & ((w & rop.ps) ^ rop.pc)) ^ (w & rop.bm));
+
+                si += 4;
+                acc = bmp__fetch(srow, si, src_stride, src_lsb);
+                db += 3;
+                continue;
+            }
+#endif
+            acc = (uint16_t)(acc << 8 | bmp__fetch(srow, ++si, src_stride, src_lsb));
+            bits = (uint8_t)(acc >> (8 - sh));
+            if (dst->lsb)
+                bits = bmp__rev8(bits);
+
+            if (db == db0)
+                mask &= head;
+            if (db == db1)
+                mask &= tail;
+            bmp__rop8(&drow[db], bits, mask, &rop);
+        }
+    }
+}
+
+/* Page layout: gather up to 8 source rows into each destination column byte. */
+BMP_INLINE void bmp__blit_page(const bmp_surface *dst, int x, int y,
+                               const uint8_t *src, int src_stride, int src_lsb,
+                               int sx0, int sy0, int cw, int ch, int op)
+{
+    int dy0 = y + sy0;
+    int dy1 = dy0 + ch;
+    bmp__rop rop = bmp__rop_for(op);
+    int page;
+
+    for (page = dy0 >> 3; page <= (dy1 - 1) >> 3; page++) {
+        int r0 = page * 8 > dy0 ? page * 8 : dy0;
+        int r1 = page * 8 + 8 < dy1 ? page * 8 + 8 : dy1;
+        uint8_t mask = (uint8_t)((0xFF << (r0 & 7)) & (0xFF >> (7 - ((r1 - 1) & 7))));
+        uint8_t *dcol = dst->buf + page * dst->stride + x + sx0;
+        int c;
+
+        for (c = 0; c < cw; c++) {
+            int sx = sx0 + c;
+            int shift = src_lsb ? (sx & 7) : 7 - (sx & 7);
+            const uint8_t *sp = src + (r0 - y) * src_stride + (sx >> 3);
+            uint8_t bits = 0;
+            int r;
+
+            for (r = r0; r < r1; r++, sp += src_stride)
+                bits |= (uint8_t)(((*sp >> shift) & 1) << (r & 7));
+            bmp__rop8(&dcol[c], bits, mask, &rop);
+        }
+    }
+}
+
+/*
+ * Draw a w x h bitmap with its top-left corner at (x, y), clipped to the
+ * surface. src_lsb is nonzero if src was converted with --lsb; op is one
+ * of BMP_OP_*.
+ */
+BMP_INLINE void bmp_blit(const bmp_surface *dst, int x, int y,
+                         const uint8_t *src, int w, int h, int src_lsb, int op)
+{
+    int src_stride = (w + 7) / 8;
+    int sx0 = x < 0 ? -x : 0;
+    int sy0 = y < 0 ? -y : 0;
+    int cw = (x + w > dst->width ? dst->width - x : w) - sx0;
+    int ch = (y + h > dst->height ? dst->height - y : h) - sy0;
+
+    if (cw <= 0 || ch <= 0)
+        return;
+
+    if (dst->layout == BMP_LAYOUT_PAGE)
+        bmp__blit_page(dst, x, y, src, src_stride, src_lsb, sx0, sy0, cw, ch, op);
+    else
+        bmp__blit_row(dst, x, y, src, src_stride, src_lsb, sx0, sy0, cw, ch, op);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP_BLIT_H */
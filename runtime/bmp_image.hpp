@@ -0,0 +1,102 @@
+/*
+ * bmp_image.hpp - compile-time sized wrapper for 1bpp2c bitmaps (C++14).
+ *
+ * Wrap the emitted data by pasting its initializer list:
+ *
+ *   constexpr bmp_image<BMP_WIDTH, BMP_HEIGHT> logo{{ 0x7A, 0x31, ... }};
+ *
+ * Use bmp_image<W, H, true> for data converted with --lsb. Width, height,
+ * stride and bit order are template parameters, so pixel() can be
+ * evaluated at compile time. blit() (row-layout framebuffers) and
+ * blit_page() (page-layout, SSD1306-style) have fixed trip counts on their
+ * fast path, so the compiler can unroll and vectorize them. Clipped or
+ * unaligned draws fall back to the runtime bmp_blit().
+ */
+#ifndef BMP_IMAGE_HPP
+#define BMP_IMAGE_HPP
+
+#include <array>
+#include <cstdint>
+
+#include "bmp_blit.h"
+
+template <int W, int H, bool Lsb = false>
+struct bmp_image {
+    static_assert(W > 0 && H > 0, "bmp_image dimensions must be positive");
+
+    static constexpr int width = W;
+    static constexpr int height = H;
+    static constexpr int stride = (W + 7) / 8;
+    static constexpr bool lsb = Lsb;
+
+    std::array<std::uint8_t, stride * H> data;
+
+    constexpr bool pixel(int x, int y) const
+    {
+        return (data[y * stride + x / 8] >> (Lsb ? (x & 7) : 7 - (x & 7))) & 1;
+    }
+
+    /*
+     * Draw into a row-layout framebuffer of FbWidth x FbHeight pixels with
+     * FbLsb bit order. When x is byte aligned, the image lies fully inside
+     * and bit orders match, rows are combined byte by byte with fixed
+     * counts; otherwise this falls back to bmp_blit().
+     */
+    template <int FbWidth, int FbHeight, bool FbLsb = false, int Op = BMP_OP_COPY>
+    void blit(std::uint8_t *fb, int x, int y) const
+    {
+        constexpr int fb_stride = (FbWidth + 7) / 8;
+
+        if (FbLsb == Lsb && (x & 7) == 0 && x >= 0 && y >= 0 &&
+            x + W <= FbWidth && y + H <= FbHeight) {
+            // Mask off the padding bits of the last byte in each row.
+            constexpr std::uint8_t tail = W % 8 == 0 ? 0xFF
+                : Lsb ? static_cast<std::uint8_t>(0xFF >> (8 - W % 8))
+                      : static_cast<std::uint8_t>(0xFF << (8 - W % 8));
+            std::uint8_t *drow = fb + y * fb_stride + x / 8;
+
+            for (int r = 0; r < H; r++, drow += fb_stride) {
+                const std::uint8_t *srow = &data[r * stride];
+                for (int b = 0; b < stride; b++)
+                    bmp__apply(&drow[b], srow[b], b == stride - 1 ? tail : 0xFF, Op);
+            }
+            return;
+        }
+
+        const bmp_surface s = { fb, FbWidth, FbHeight, fb_stride, BMP_LAYOUT_ROW, FbLsb };
+        bmp_blit(&s, x, y, data.data(), W, H, Lsb, Op);
+    }
+
+    /*
+     * Draw into a page-layout framebuffer of FbWidth x FbHeight pixels
+     * (FbWidth bytes per page of 8 rows, bit 0 at the top). When y is a
+     * multiple of 8 and the image lies fully inside, each column byte is
+     * gathered with fixed counts; otherwise this falls back to bmp_blit().
+     */
+    template <int FbWidth, int FbHeight, int Op = BMP_OP_COPY>
+    void blit_page(std::uint8_t *fb, int x, int y) const
+    {
+        if ((y & 7) == 0 && x >= 0 && y >= 0 && x + W <= FbWidth && y + H <= FbHeight) {
+            constexpr int pages = (H + 7) / 8;
+            std::uint8_t *dpage = fb + y / 8 * FbWidth + x;
+
+            for (int p = 0; p < pages; p++, dpage += FbWidth) {
+                const int rows = p == pages - 1 ? H - p * 8 : 8;
+                const std::uint8_t mask = static_cast<std::uint8_t>(0xFF >> (8 - rows));
+
+                for (int c = 0; c < W; c++) {
+                    std::uint8_t bits = 0;
+                    for (int r = 0; r < rows; r++)
+                        bits |= static_cast<std::uint8_t>(pixel(c, p * 8 + r) << r);
+                    bmp__apply(&dpage[c], bits, mask, Op);
+                }
+            }
+            return;
+        }
+
+        const bmp_surface s = { fb, FbWidth, FbHeight, FbWidth, BMP_LAYOUT_PAGE, 0 };
+        bmp_blit(&s, x, y, data.data(), W, H, Lsb, Op);
+    }
+};
+
+#endif /* BMP_IMAGE_HPP */
@@ -0,0 +1,186 @@
+/*
+ * bmp_scale.h - integer upscaling of 1bpp2c bitmaps by table lookup.
+ *
+ * Header-only. Works on bmp_data[] as emitted by 1bpp2c: rows of
+ * (BMP_WIDTH + 7) / 8 bytes, MSB first by default or LSB first with --lsb.
+ * Upscaled output has the same layout, so it can be passed to bmp_blit().
+ *
+ * Each table spreads source bit b to output bits b*f .. b*f+f-1. That
+ * mapping is the same for both bit orders; only the order in which the
+ * output bytes are stored differs (high byte first for MSB, low byte
+ * first for LSB), so one set of tables serves both.
+ */
+#ifndef BMP_SCALE_H
+#define BMP_SCALE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "bmp_blit.h"
+
+#ifndef BMP_INLINE
+#define BMP_INLINE static inline
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 2x: byte -> 16 bits. */
+static const uint16_t bmp_scale2_lut[256] = {
+    0x0000, 0x0003, 0x000C, 0x000F, 0x0030, 0x0033, 0x003C, 0x003F,
+    0x00C0, 0x00C3, 0x00CC, 0x00CF, 0x00F0, 0x00F3, 0x00FC, 0x00FF,
+    0x0300, 0x0303, 0x030C, 0x030F, 0x0330, 0x0333, 0x033C, 0x033F,
+    0x03C0, 0x03C3, 0x03CC, 0x03CF, 0x03F0, 0x03F3, 0x03FC, 0x03FF,
+    0x0C00, 0x0C03, 0x0C0C, 0x0C0F, 0x0C30, 0x0C33, 0x0C3C, 0x0C3F,
+    0x0CC0, 0x0CC3, 0x0CCC, 0x0CCF, 0x0CF0, 0x0CF3, 0x0CFC, 0x0CFF,
+    0x0F00, 0x0F03, 0x0F0C, 0x0F0F, 0x0F30, 0x0F33, 0x0F3C, 0x0F3F,
+    0x0FC0, 0x0FC3, 0x0FCC, 0x0FCF, 0x0FF0, 0x0FF3, 0x0FFC, 0x0FFF,
+    0x3000, 0x3003, 0x300C, 0x300F, 0x3030, 0x3033, 0x303C, 0x303F,
+    0x30C0, 0x30C3, 0x30CC, 0x30CF, 0x30F0, 0x30F3, 0x30FC, 0x30FF,
+    0x3300, 0x3303, 0x330C, 0x330F, 0x3330, 0x3333, 0x333C, 0x333F,
+    0x33C0, 0x33C3, 0x33CC, 0x33CF, 0x33F0, 0x33F3, 0x33FC, 0x33FF,
+    0x3C00, 0x3C03, 0x3C0C, 0x3C0F, 0x3C30, 0x3C33, 0x3C3C, 0x3C3F,
+    0x3CC0, 0x3CC3, 0x3CCC, 0x3CCF, 0x3CF0, 0x3CF3, 0x3CFC, 0x3CFF,
+    0x3F00, 0x3F03, 0x3F0C, 0x3F0F, 0x3F30, 0x3F33, 0x3F3C, 0x3F3F,
+    0x3FC0, 0x3FC3, 0x3FCC, 0x3FCF, 0x3FF0, 0x3FF3, 0x3FFC, 0x3FFF,
+    0xC000, 0xC003, 0xC00C, 0xC00F, 0xC030, 0xC033, 0xC03C, 0xC03F,
+    0xC0C0, 0xC0C3, 0xC0CC, 0xC0CF, 0xC0F0, 0xC0F3, 0xC0FC, 0xC0FF,
+    0xC300, 0xC303, 0xC30C, 0xC30F, 0xC330, 0xC333, 0xC33C, 0xC33F,
+    0xC3C0, 0xC3C3, 0xC3CC, 0xC3CF, 0xC3F0, 0xC3F3, 0xC3FC, 0xC3FF,
+    0xCC00, 0xCC03, 0xCC0C, 0xCC0F, 0xCC30, 0xCC33, 0xCC3C, 0xCC3F,
+    0xCCC0, 0xCCC3, 0xCCCC, 0xCCCF, 0xCCF0, 0xCCF3, 0xCCFC, 0xCCFF,
+    0xCF00, 0xCF03, 0xCF0C, 0xCF0F, 0xCF30, 0xCF33, 0xCF3C, 0xCF3F,
+    0xCFC0, 0xCFC3, 0xCFCC, 0xCFCF, 0xCFF0, 0xCFF3, 0xCFFC, 0xCFFF,
+    0xF000, 0xF003, 0xF00C, 0xF00F, 0xF030, 0xF033, 0xF03C, 0xF03F,
+    0xF0C0, 0xF0C3, 0xF0CC, 0xF0CF, 0xF0F0, 0xF0F3, 0xF0FC, 0xF0FF,
+    0xF300, 0xF303, 0xF30C, 0xF30F, 0xF330, 0xF333, 0xF33C, 0xF33F,
+    0xF3C0, 0xF3C3, 0xF3CC, 0xF3CF, 0xF3F0, 0xF3F3, 0xF3FC, 0xF3FF,
+    0xFC00, 0xFC03, 0xFC0C, 0xFC0F, 0xFC30, 0xFC33, 0xFC3C, 0xFC3F,
+    0xFCC0, 0xFCC3, 0xFCCC, 0xFCCF, 0xFCF0, 0xFCF3, 0xFCFC, 0xFCFF,
+    0xFF00, 0xFF03, 0xFF0C, 0xFF0F, 0xFF30, 0xFF33, 0xFF3C, 0xFF3F,
+    0xFFC0, 0xFFC3, 0xFFCC, 0xFFCF, 0xFFF0, 0xFFF3, 0xFFFC, 0xFFFF,
+};
+
+/* 3x: nibble -> 12 bits. */
+static const uint16_t bmp_scale3_lut[16] = {
+    0x000, 0x007, 0x038, 0x03F, 0x1C0, 0x1C7, 0x1F8, 0x1FF,
+    0xE00, 0xE07, 0xE38, 0xE3F, 0xFC0, 0xFC7, 0xFF8, 0xFFF,
+};
+
+/* 4x: nibble -> 16 bits. */
+static const uint16_t bmp_scale4_lut[16] = {
+    0x0000, 0x000F, 0x00F0, 0x00FF, 0x0F00, 0x0F0F, 0x0FF0, 0x0FFF,
+    0xF000, 0xF00F, 0xF0F0, 0xF0FF, 0xFF00, 0xFF0F, 0xFFF0, 0xFFFF,
+};
+
+/* Bytes per row of a width-pixel row upscaled by factor. */
+#define BMP_SCALE_STRIDE(width, factor) (((width) * (factor) + 7) / 8)
+
+/* Source bytes upscaled per pass by bmp_upscale_blit(). */
+#ifndef BMP_SCALE_CHUNK
+#define BMP_SCALE_CHUNK 8
+#endif
+
+/*
+ * Upscale one row of width pixels horizontally into
+ * BMP_SCALE_STRIDE(width, factor) bytes at dst, with the padding bits of
+ * the last byte cleared. factor is 2, 3 or 4; other values leave dst
+ * untouched.
+ */
+BMP_INLINE void bmp_upscale_row(const uint8_t *src, int width,
+                                int factor, int lsb, uint8_t *dst)
+{
+    int out = BMP_SCALE_STRIDE(width, factor);
+    int valid = width * factor - 8 * (out - 1); /* used bits in the last byte */
+    int i, k, n = 0;
+
+    if (factor < 2 || factor > 4 || width <= 0)
+        return;
+
+    for (i = 0; n < out; i++) {
+        uint8_t s = src[i];
+        uint32_t v;
+
+        if (factor == 2)
+            v = bmp_scale2_lut[s];
+        else if (factor == 3)
+            v = ((uint32_t)bmp_scale3_lut[s >> 4] << 12) | bmp_scale3_lut[s & 0x0F];
+        else
+            v = ((uint32_t)bmp_scale4_lut[s >> 4] << 16) | bmp_scale4_lut[s & 0x0F];
+
+        for (k = 0; k < factor && n < out; k++, n++)
+            dst[n] = (uint8_t)(v >> (8 * (lsb ? k : factor - 1 - k)));
+    }
+
+    dst[out - 1] &= lsb ? (uint8_t)(0xFF >> (8 - valid)) : (uint8_t)(0xFF << (8 - valid));
+}
+
+/*
+ * Upscale a whole bitmap into dst in bmp_data[] layout: width * factor by
+ * height * factor pixels, BMP_SCALE_STRIDE(width, factor) bytes per row.
+ * Each scaled row is produced once and copied for the remaining
+ * factor - 1 rows.
+ */
+BMP_INLINE void bmp_upscale(const uint8_t *src, int width, int height,
+                            int factor, int lsb, uint8_t *dst)
+{
+    int src_stride = (width + 7) / 8;
+    int dst_stride = BMP_SCALE_STRIDE(width, factor);
+    int y, r;
+
+    if (factor < 2 || factor > 4)
+        return;
+
+    for (y = 0; y < height; y++) {
+        bmp_upscale_row(src, width, factor, lsb, dst);
+        for (r = 1; r < factor; r++)
+            memcpy(dst + r * dst_stride, dst, (size_t)dst_stride);
+        src += src_stride;
+        dst += dst_stride * factor;
+    }
+}
+
+/*
+ * Draw a w x h bitmap upscaled by factor with its top-left corner at
+ * (x, y), clipped to the surface. Works through a stack buffer of
+ * BMP_SCALE_CHUNK * factor bytes, upscaling BMP_SCALE_CHUNK source bytes
+ * at a time and drawing each piece with bmp_blit(), so no full-size copy
+ * is needed. Rows and pieces that fall outside the surface are skipped.
+ */
+BMP_INLINE void bmp_upscale_blit(const bmp_surface *dst, int x, int y,
+                                 const uint8_t *src, int w, int h, int src_lsb,
+                                 int factor, int op)
+{
+    uint8_t buf[BMP_SCALE_CHUNK * 4];
+    int src_stride = (w + 7) / 8;
+    int sy, k, r;
+
+    if (factor < 2 || factor > 4)
+        return;
+
+    for (sy = 0; sy < h; sy++) {
+        int dy = y + sy * factor;
+
+        if (dy + factor <= 0 || dy >= dst->height)
+            continue;
+
+        for (k = 0; k < src_stride; k += BMP_SCALE_CHUNK) {
+            int cw = w - k * 8 < BMP_SCALE_CHUNK * 8 ? w - k * 8 : BMP_SCALE_CHUNK * 8;
+            int dx = x + k * 8 * factor;
+
+            if (dx + cw * factor <= 0 || dx >= dst->width)
+                continue;
+
+            bmp_upscale_row(src + sy * src_stride + k, cw, factor, src_lsb, buf);
+            for (r = 0; r < factor; r++)
+                bmp_blit(dst, dx, dy + r, buf, cw * factor, 1, src_lsb, op);
+        }
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BMP_SCALE_H */
@@ -0,0 +1,112 @@
+/*
+ * bmp_image_test.cpp - compile-time and fast-path checks for bmp_image.
+ *
+ *   c++ -std=c++14 -Wall -Wextra -pedantic -I runtime runtime/test/bmp_image_test.cpp -o bmp_image_test
+ *
+ * pixel() is checked with static_assert. blit() and blit_page() are
+ * compared against bmp_blit() at every position around the framebuffer,
+ * so both the fixed-size fast paths and the fallbacks are exercised.
+ * Exits nonzero on any mismatch.
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "bmp_image.hpp"
+
+// 10x2: row 0 = 1000 0000 01.., row 1 = 1111 1111 11..
+constexpr bmp_image<10, 2> msb_img{{ 0x80, 0x40, 0xFF, 0xFF }};
+static_assert(msb_img.stride == 2, "stride");
+static_assert(msb_img.pixel(0, 0) && !msb_img.pixel(1, 0), "MSB first byte");
+static_assert(!msb_img.pixel(8, 0) && msb_img.pixel(9, 0), "MSB second byte");
+static_assert(msb_img.pixel(0, 1) && msb_img.pixel(9, 1), "second row");
+
+constexpr bmp_image<10, 2, true> lsb_img{{ 0x01, 0x02, 0x00, 0x00 }};
+static_assert(lsb_img.pixel(0, 0) && !lsb_img.pixel(7, 0), "LSB first byte");
+static_assert(!lsb_img.pixel(8, 0) && lsb_img.pixel(9, 0), "LSB second byte");
+static_assert(!lsb_img.pixel(0, 1), "LSB second row");
+
+namespace {
+
+constexpr int FB_W = 40;
+constexpr int FB_H = 24;
+constexpr int ROW_SIZE = (FB_W + 7) / 8 * FB_H;
+constexpr int PAGE_SIZE = FB_W * ((FB_H + 7) / 8);
+
+template <int W, int H, bool Lsb, bool FbLsb, int Op>
+int compare_row()
+{
+    bmp_image<W, H, Lsb> img{};
+    int failures = 0;
+
+    for (auto &b : img.data)
+        b = static_cast<std::uint8_t>(std::rand());
+
+    for (int y = -H - 1; y <= FB_H + 1; y++) {
+        for (int x = -W - 1; x <= FB_W + 1; x++) {
+            std::uint8_t got[ROW_SIZE], want[ROW_SIZE];
+            for (int i = 0; i < ROW_SIZE; i++)
+                got[i] = want[i] = static_cast<std::uint8_t>(std::rand());
+
+            img.template blit<FB_W, FB_H, FbLsb, Op>(got, x, y);
+            const bmp_surface s = { want, FB_W, FB_H, (FB_W + 7) / 8, BMP_LAYOUT_ROW, FbLsb };
+            bmp_blit(&s, x, y, img.data.data(), W, H, Lsb, Op);
+
+            failures += std::memcmp(got, want, ROW_SIZE) != 0;
+        }
+    }
+    if (failures)
+        std::printf("blit<%d,%d,%d,%d,%d>: %d mismatches\n", W, H, Lsb, FbLsb, Op, failures);
+    return failures;
+}
+
+template <int W, int H, bool Lsb, int Op>
+int compare_page()
+{
+    bmp_image<W, H, Lsb> img{};
+    int failures = 0;
+
+    for (auto &b : img.data)
+        b = static_cast<std::uint8_t>(std::rand());
+
+    for (int y = -H - 1; y <= FB_H + 1; y++) {
+        for (int x = -W - 1; x <= FB_W + 1; x++) {
+            std::uint8_t got[PAGE_SIZE], want[PAGE_SIZE];
+            for (int i = 0; i < PAGE_SIZE; i++)
+                got[i] = want[i] = static_cast<std::uint8_t>(std::rand());
+
+            img.template blit_page<FB_W, FB_H, Op>(got, x, y);
+            const bmp_surface s = { want, FB_W, FB_H, FB_W, BMP_LAYOUT_PAGE, 0 };
+            bmp_blit(&s, x, y, img.data.data(), W, H, Lsb, Op);
+
+            failures += std::memcmp(got, want, PAGE_SIZE) != 0;
+        }
+    }
+    if (failures)
+        std::printf("blit_page<%d,%d,%d,%d>: %d mismatches\n", W, H, Lsb, Op, failures);
+    return failures;
+}
+
+} // namespace
+
+int main()
+{
+    int failures = 0;
+
+    std::srand(1);
+
+    failures += compare_row<13, 5, false, false, BMP_OP_COPY>();
+    failures += compare_row<13, 5, true, true, BMP_OP_COPY>();
+    failures += compare_row<16, 7, false, false, BMP_OP_OR>();
+    failures += compare_row<9, 3, true, true, BMP_OP_AND>();
+    failures += compare_row<13, 5, false, true, BMP_OP_XOR>();
+
+    failures += compare_page<13, 5, false, BMP_OP_COPY>();
+    failures += compare_page<13, 5, true, BMP_OP_COPY>();
+    failures += compare_page<16, 8, false, BMP_OP_OR>();
+    failures += compare_page<9, 11, true, BMP_OP_AND>();
+    failures += compare_page<7, 16, false, BMP_OP_XOR>();
+
+    std::printf("%d mismatches\n", failures);
+    return failures != 0;
+}
@@ -0,0 +1,119 @@
+/*
+ * bmp_scale_test.c - compare bmp_upscale() and bmp_upscale_blit() against
+ * nearest-neighbour per-pixel output.
+ *
+ *   cc -std=c99 -Wall -Wextra -I runtime runtime/test/bmp_scale_test.c -o bmp_scale_test
+ *
+ * Covers factors 2, 3 and 4 and both bit orders. bmp_upscale() output is
+ * checked pixel by pixel, including that row padding is cleared.
+ * bmp_upscale_blit() is checked on random row- and page-layout surfaces
+ * and positions. Exits nonzero on any mismatch.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bmp_scale.h"
+
+#define CASES 20000
+#define MAX_SPRITE 80
+#define MAX_SURFACE 200
+
+static int pixel(const uint8_t *buf, int stride, int x, int y, int lsb)
+{
+    uint8_t v = buf[y * stride + x / 8];
+    return (v >> (lsb ? (x & 7) : 7 - (x & 7))) & 1;
+}
+
+static int check_upscale(const uint8_t *src, int w, int h, int factor, int lsb)
+{
+    static uint8_t out[BMP_SCALE_STRIDE(MAX_SPRITE, 4) * MAX_SPRITE * 4];
+    int src_stride = (w + 7) / 8;
+    int stride = BMP_SCALE_STRIDE(w, factor);
+    int x, y;
+
+    bmp_upscale(src, w, h, factor, lsb, out);
+    for (y = 0; y < h * factor; y++) {
+        for (x = 0; x < stride * 8; x++) {
+            int want = x < w * factor ? pixel(src, src_stride, x / factor, y / factor, lsb) : 0;
+            if (pixel(out, stride, x, y, lsb) != want)
+                return 0;
+        }
+    }
+    return 1;
+}
+
+static int check_upscale_blit(const uint8_t *src, int w, int h, int factor, int lsb)
+{
+    static uint8_t got[MAX_SURFACE * MAX_SURFACE];
+    static uint8_t want[MAX_SURFACE * MAX_SURFACE];
+    int src_stride = (w + 7) / 8;
+    int width = 1 + rand() % MAX_SURFACE;
+    int height = 1 + rand() % MAX_SURFACE;
+    int layout = rand() % 2;
+    int stride = layout == BMP_LAYOUT_PAGE ? width : (width + 7) / 8;
+    int size = layout == BMP_LAYOUT_PAGE ? (height + 7) / 8 * stride : height * stride;
+    int x = rand() % (width + w * factor) - w * factor / 2;
+    int y = rand() % (height + h * factor) - h * factor / 2;
+    int op = rand() % 4;
+    bmp_surface s, r;
+    int k, sx, sy;
+
+    for (k = 0; k < size; k++)
+        got[k] = want[k] = (uint8_t)rand();
+
+    s.buf = got;
+    s.width = width;
+    s.height = height;
+    s.stride = stride;
+    s.layout = (uint8_t)layout;
+    s.lsb = (uint8_t)(rand() % 2);
+    r = s;
+    r.buf = want;
+
+    bmp_upscale_blit(&s, x, y, src, w, h, lsb, factor, op);
+
+    /* Reference: draw each source pixel as a factor x factor block. */
+    for (sy = 0; sy < h; sy++) {
+        for (sx = 0; sx < w; sx++) {
+            uint8_t block = pixel(src, src_stride, sx, sy, lsb) ? 0xFF : 0x00;
+            int by;
+
+            for (by = 0; by < factor; by++)
+                bmp_blit(&r, x + sx * factor, y + sy * factor + by, &block, factor, 1, lsb, op);
+        }
+    }
+
+    return memcmp(got, want, (size_t)size) == 0;
+}
+
+int main(void)
+{
+    static uint8_t src[(MAX_SPRITE + 7) / 8 * MAX_SPRITE];
+    long failures = 0;
+    long i;
+
+    srand(1);
+    for (i = 0; i < CASES; i++) {
+        int w = 1 + rand() % MAX_SPRITE;
+        int h = 1 + rand() % (MAX_SPRITE / 4);
+        int factor = 2 + rand() % 3;
+        int lsb = rand() % 2;
+        int k;
+
+        for (k = 0; k < (w + 7) / 8 * h; k++)
+            src[k] = (uint8_t)rand();
+
+        if (!check_upscale(src, w, h, factor, lsb)) {
+            if (failures++ < 10)
+                printf("bmp_upscale mismatch: %dx%d x%d lsb %d\n", w, h, factor, lsb);
+        }
+        if (!check_upscale_blit(src, w, h, factor, lsb)) {
+            if (failures++ < 10)
+                printf("bmp_upscale_blit mismatch: %dx%d x%d lsb %d\n", w, h, factor, lsb);
+        }
+    }
+
+    printf("%ld/%d cases failed\n", failures, CASES);
+    return failures != 0;
+}